@@ -0,0 +1,291 @@
+/* Copyright (c) 2026, Bogdan Pricope
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:	BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "nfp.h"
+#include "pkt_dispatcher.h"
+
+void nfpexpl_dispatcher_param_init(nfpexpl_dispatcher_param_t *param)
+{
+	memset(param, 0, sizeof(*param));
+
+	param->burst_size = NFP_PKT_VECTOR_SIZE;
+	param->sched_interval = 1;
+	param->pkt_multi_func = nfp_eth_vlan_processing_multi;
+	param->pkt_func = nfp_eth_vlan_processing;
+	param->idle_wait_min = 1000;
+	param->idle_spin = 1000;
+	param->prefetch_depth = 4;
+}
+
+static void sched_events_process(int burst_size)
+{
+	odp_queue_t in_queue;
+	odp_event_t events[NFP_PKT_VECTOR_SIZE], ev;
+	int event_cnt, i;
+
+	event_cnt = odp_schedule_multi(&in_queue, ODP_SCHED_NO_WAIT,
+				       events, burst_size);
+	for (i = 0; i < event_cnt; i++) {
+		ev = events[i];
+
+		if (ev == ODP_EVENT_INVALID)
+			continue;
+
+		if (odp_event_type(ev) == ODP_EVENT_TIMEOUT) {
+			nfp_timer_handle(ev);
+			continue;
+		} else if (odp_event_type(ev) == ODP_EVENT_PACKET) {
+			nfp_packet_input(/*loopbacked, SP pkts*/
+				odp_packet_from_event(ev),
+				in_queue,
+				nfp_eth_vlan_processing);
+			continue;
+		}
+
+		odp_event_free(ev);
+	}
+}
+
+/* Send the pending packets when nothing was received during the last
+ * iteration or when the deadline expired since the previous flush. */
+static inline void tx_flush(int rx_cnt, uint64_t deadline, odp_time_t *last)
+{
+	odp_time_t now;
+
+	if (deadline == 0) {
+		nfp_send_pending_pkt();
+		return;
+	}
+
+	now = odp_time_local();
+	if (rx_cnt == 0 || odp_time_diff_ns(now, *last) >= deadline) {
+		nfp_send_pending_pkt();
+		*last = now;
+	}
+}
+
+static inline void pkt_prefetch(odp_packet_t pkt)
+{
+	odp_packet_prefetch(pkt, 0, ODP_CACHE_LINE_SIZE);
+	odp_prefetch(odp_packet_user_area(pkt));
+}
+
+static void pkt_tbl_process(nfpexpl_dispatcher_param_t *param,
+			    nfp_pkt_vector_t *vec, odp_packet_t pkt_tbl[],
+			    int pkt_cnt)
+{
+	int depth = param->prefetch_depth;
+	int i;
+
+	/* Prefetch the first packets, then keep 'depth' packets ahead */
+	for (i = 0; i < depth && i < pkt_cnt; i++)
+		pkt_prefetch(pkt_tbl[i]);
+
+	if (param->pkt_multi_func == NULL) {
+		for (i = 0; i < pkt_cnt; i++) {
+			if (depth && i + depth < pkt_cnt)
+				pkt_prefetch(pkt_tbl[i + depth]);
+
+			nfp_packet_input(pkt_tbl[i], ODP_QUEUE_INVALID,
+					 param->pkt_func);
+		}
+		return;
+	}
+
+	for (i = 0; i < pkt_cnt; i++) {
+		if (depth && i + depth < pkt_cnt)
+			pkt_prefetch(pkt_tbl[i + depth]);
+
+		if (nfp_pkt_vector_add(vec, pkt_tbl[i]) != 1) {
+			odp_packet_free(pkt_tbl[i]);
+			continue;
+		}
+
+		if (vec->num >= param->burst_size) {
+			nfp_packet_input_multi(vec, ODP_QUEUE_INVALID,
+					       param->pkt_multi_func);
+			nfp_pkt_vector_init(vec);
+		}
+	}
+}
+
+static int dispatcher_param_check(nfpexpl_dispatcher_param_t *param)
+{
+	if (param == NULL) {
+		NFP_ERR("Invalid dispatcher parameters");
+		return -1;
+	}
+
+	if (param->num_pktin < 0 ||
+	    param->num_pktin > NFPEXPL_DISPATCHER_PKTIN_MAX) {
+		NFP_ERR("Invalid number of pktin queues: %d",
+			param->num_pktin);
+		return -1;
+	}
+
+	if (param->burst_size < 1 ||
+	    param->burst_size > NFP_PKT_VECTOR_SIZE) {
+		NFP_ERR("Invalid burst size: %d", param->burst_size);
+		return -1;
+	}
+
+	if (param->prefetch_depth < 0 ||
+	    param->prefetch_depth > NFP_PKT_VECTOR_SIZE) {
+		NFP_ERR("Invalid prefetch depth: %d", param->prefetch_depth);
+		return -1;
+	}
+
+	if (param->budget < 0) {
+		NFP_ERR("Invalid budget: %d", param->budget);
+		return -1;
+	}
+
+	if (param->pkt_multi_func == NULL && param->pkt_func == NULL) {
+		NFP_ERR("Packet processing function not set");
+		return -1;
+	}
+
+	if (param->idle_wait_max &&
+	    (param->idle_wait_min == 0 ||
+	     param->idle_wait_min > param->idle_wait_max)) {
+		NFP_ERR("Invalid idle wait range: %" PRIu64 " - %" PRIu64,
+			param->idle_wait_min, param->idle_wait_max);
+		return -1;
+	}
+
+	return 0;
+}
+
+int nfpexpl_direct_dispatcher(void *arg)
+{
+	nfpexpl_dispatcher_param_t *param = (nfpexpl_dispatcher_param_t *)arg;
+	odp_packet_t pkt_tbl[NFP_PKT_VECTOR_SIZE];
+	nfp_pkt_vector_t vec;
+	odp_bool_t *is_running = NULL;
+	int burst_size, budget, num_pktin;
+	int rx_cnt, pkt_cnt, num, q_start, q, i;
+	uint32_t sched_interval, sched_cnt, idle_cnt;
+	uint64_t idle_wait, cycles_start, cycles_end, wait_cycles;
+	unsigned int from;
+	odp_time_t tx_last;
+
+	if (dispatcher_param_check(param))
+		return -1;
+
+	num_pktin = param->num_pktin;
+	burst_size = param->burst_size;
+	budget = param->budget;
+	sched_interval = param->sched_interval ? param->sched_interval : 1;
+
+	is_running = nfp_get_processing_state();
+	if (is_running == NULL) {
+		NFP_ERR("nfp_get_processing_state failed");
+		return -1;
+	}
+
+	printf("PKT-IO receive starting on cpu: %i, %i\n", odp_cpu_id(),
+	       num_pktin);
+
+	nfp_pkt_vector_init(&vec);
+	q_start = 0;
+	sched_cnt = 0;
+	idle_cnt = 0;
+	idle_wait = param->idle_wait_min;
+	tx_last = odp_time_local();
+	memset(&param->stats, 0, sizeof(param->stats));
+
+	while (*is_running) {
+		cycles_start = odp_cpu_cycles();
+		wait_cycles = 0;
+
+		if (param->process_timers && ++sched_cnt >= sched_interval) {
+			sched_cnt = 0;
+			sched_events_process(burst_size);
+		}
+
+		rx_cnt = 0;
+		for (i = 0; i < num_pktin; i++) {
+			q = (q_start + i) % num_pktin;
+
+			num = burst_size;
+			if (budget) {
+				if (rx_cnt >= budget)
+					break;
+				if (budget - rx_cnt < num)
+					num = budget - rx_cnt;
+			}
+
+			pkt_cnt = odp_pktin_recv(param->pktin[q], pkt_tbl, num);
+			if (pkt_cnt <= 0)
+				continue;
+			rx_cnt += pkt_cnt;
+
+			pkt_tbl_process(param, &vec, pkt_tbl, pkt_cnt);
+		}
+
+		/* Round-robin: next iteration starts with the first queue not
+		 * polled (budget exhausted) or with the next queue. */
+		if (num_pktin)
+			q_start = (q_start + (i < num_pktin ? i : 1)) %
+				num_pktin;
+
+		if (rx_cnt) {
+			idle_cnt = 0;
+			idle_wait = param->idle_wait_min;
+		} else if (param->idle_wait_max && !param->process_timers &&
+			   num_pktin && ++idle_cnt > param->idle_spin) {
+			/* Idle: send the pending packets and wait for traffic,
+			 * backing off progressively. The worker servicing the
+			 * scheduled events (timers) never waits. */
+			nfp_send_pending_pkt();
+
+			wait_cycles = odp_cpu_cycles();
+			pkt_cnt = odp_pktin_recv_mq_tmo(param->pktin,
+					num_pktin, &from, pkt_tbl, burst_size,
+					odp_pktin_wait_time(idle_wait));
+			wait_cycles = odp_cpu_cycles_diff(odp_cpu_cycles(),
+							  wait_cycles);
+			param->stats.idle_waits++;
+
+			if (pkt_cnt > 0) {
+				rx_cnt = pkt_cnt;
+				pkt_tbl_process(param, &vec, pkt_tbl, pkt_cnt);
+				idle_cnt = 0;
+				idle_wait = param->idle_wait_min;
+			} else if (idle_wait < param->idle_wait_max) {
+				idle_wait *= 2;
+				if (idle_wait > param->idle_wait_max)
+					idle_wait = param->idle_wait_max;
+			}
+		}
+
+		if (NFP_PKT_VECTOR_HAS_DATA(&vec)) {
+			nfp_packet_input_multi(&vec, ODP_QUEUE_INVALID,
+					       param->pkt_multi_func);
+			nfp_pkt_vector_init(&vec);
+		}
+
+		tx_flush(rx_cnt, param->tx_deadline, &tx_last);
+
+		/* The time spent waiting is idle, even when the wait ends
+		 * with received packets. */
+		cycles_end = odp_cpu_cycles();
+		if (rx_cnt) {
+			param->stats.busy_cycles +=
+				odp_cpu_cycles_diff(cycles_end, cycles_start) -
+				wait_cycles;
+			param->stats.idle_cycles += wait_cycles;
+		} else {
+			param->stats.idle_cycles +=
+				odp_cpu_cycles_diff(cycles_end, cycles_start);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2026, Bogdan Pricope
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:	BSD-3-Clause
+ */
+
+#ifndef __NFP_EXAMPLE_PKT_DISPATCHER__
+#define __NFP_EXAMPLE_PKT_DISPATCHER__
+
+#include "nfp.h"
+
+#define NFPEXPL_DISPATCHER_PKTIN_MAX NFP_FP_INTERFACE_MAX
+
+/**
+ * Dispatcher statistics (per worker)
+ */
+typedef struct {
+	/** CPU cycles spent in iterations that received packets */
+	uint64_t busy_cycles;
+
+	/** CPU cycles spent in idle iterations and waiting for packets */
+	uint64_t idle_cycles;
+
+	/** Number of idle waits on the pktin queues */
+	uint64_t idle_waits;
+} nfpexpl_dispatcher_stats_t;
+
+/**
+ * Direct mode (pktin polling) dispatcher parameters
+ */
+typedef struct {
+	/** Number of pktin queues polled by the dispatcher */
+	int num_pktin;
+
+	/** Pktin queues opened in ODP_PKTIN_MODE_DIRECT */
+	odp_pktin_queue_t pktin[NFPEXPL_DISPATCHER_PKTIN_MAX];
+
+	/** Maximum number of packets received from a pktin queue at once
+	 * (1 - NFP_PKT_VECTOR_SIZE). Default: NFP_PKT_VECTOR_SIZE */
+	int burst_size;
+
+	/** Maximum number of packets received from all pktin queues
+	 * during a dispatcher iteration. The polling continues with the
+	 * next queue on the next iteration (round-robin), so that busy
+	 * queues do not starve the others. Default: 0 (no limit) */
+	int budget;
+
+	/** Process the scheduled events (timers, loopback and slow path
+	 * packets). Default: 0 */
+	odp_bool_t process_timers;
+
+	/** Number of dispatcher iterations between two services of the
+	 * scheduled events. Default: 1 */
+	uint32_t sched_interval;
+
+	/** Maximum time (ns) to keep the transmitted packets for a larger
+	 * burst while receiving. Pending packets are sent when an iteration
+	 * receives nothing or on deadline expiration.
+	 * Default: 0 (send on every iteration) */
+	uint64_t tx_deadline;
+
+	/** Multi-packet processing function, e.g.
+	 * nfp_eth_vlan_processing_multi. If NULL, the packets are processed
+	 * one by one with 'pkt_func'. Default: nfp_eth_vlan_processing_multi */
+	nfp_pkt_processing_multi_func pkt_multi_func;
+
+	/** Packet processing function. Default: nfp_eth_vlan_processing */
+	nfp_pkt_processing_func pkt_func;
+
+	/** Hybrid poll/wait mode: maximum time (ns) to wait for packets
+	 * on the pktin queues when idle. The dispatcher busy-polls while
+	 * there is traffic. After 'idle_spin' consecutive idle iterations,
+	 * it waits with odp_pktin_recv_mq_tmo(), starting with
+	 * 'idle_wait_min' and doubling the wait time up to 'idle_wait_max'
+	 * while no packets are received. Ignored when 'process_timers' is
+	 * set: the worker servicing the timers always busy-polls.
+	 * Default: 0 (busy-polling only) */
+	uint64_t idle_wait_max;
+
+	/** Minimum (first) idle wait time (ns). Default: 1000 */
+	uint64_t idle_wait_min;
+
+	/** Number of idle iterations before waiting. Default: 1000 */
+	uint32_t idle_spin;
+
+	/** Number of received packets prefetched ahead of the packet being
+	 * processed or added to the vector: packet data (first cache line)
+	 * and user area. 0 disables the prefetching. Default: 4 */
+	int prefetch_depth;
+
+	/** Statistics, updated by the dispatcher */
+	nfpexpl_dispatcher_stats_t stats;
+} nfpexpl_dispatcher_param_t;
+
+/**
+ * Initialize the dispatcher parameters with the default values.
+ *
+ * @param param  Parameters to initialize
+ */
+void nfpexpl_dispatcher_param_init(nfpexpl_dispatcher_param_t *param);
+
+/**
+ * Direct mode (pktin polling) event dispatcher
+ *
+ * The main processing loop of a NFP worker thread using pktin queues
+ * opened in ODP_PKTIN_MODE_DIRECT. To be used as nfp_thread_param_t start
+ * function. Runs until nfp_stop_processing() is called.
+ *
+ * @param arg  Dispatcher parameters (nfpexpl_dispatcher_param_t *)
+ * @return 0 success, -1 error
+ */
+int nfpexpl_direct_dispatcher(void *arg);
+
+#endif /* __NFP_EXAMPLE_PKT_DISPATCHER__ */
@@ -0,0 +1,132 @@
+/* Copyright (c) 2026, Bogdan Pricope
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:	BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "nfp.h"
+#include "udp_burst.h"
+
+#define UDP_BURST_DRAIN_MAX 32
+
+static void udp_burst_notify(union nfp_sigval *sv)
+{
+	struct nfp_sock_sigval *ss = (struct nfp_sock_sigval *)sv;
+	nfpexpl_udp_burst_t *ub;
+	struct nfp_sockaddr_in addr;
+	nfp_socklen_t addr_len = sizeof(addr);
+	odp_packet_t pkt;
+
+	if (ss->event != NFP_EVENT_RECV)
+		return;
+
+	ub = (nfpexpl_udp_burst_t *)ss->sigev_value.sival_ptr;
+	pkt = ss->pkt;
+	/* mark packet as consumed*/
+	ss->pkt = ODP_PACKET_INVALID;
+
+	memset(&addr, 0, sizeof(addr));
+	if (nfp_udp_packet_parse(pkt, NULL, (struct nfp_sockaddr *)&addr,
+				 &addr_len) == NULL) {
+		odp_packet_free(pkt);
+		return;
+	}
+
+	if (nfp_channel_send(ub->chn, &pkt, (uint8_t *)&addr, sizeof(addr),
+			     1) != 1)
+		odp_packet_free(pkt);
+}
+
+int nfpexpl_udp_burst_init(nfpexpl_udp_burst_t *ub, int sd,
+			   odp_bool_t single_consumer)
+{
+	nfp_channel_param_t param;
+	struct nfp_sigevent ev;
+	char name[ODP_QUEUE_NAME_LEN];
+
+	if (!ub || sd < 0) {
+		NFP_ERR("Error: Invalid argument");
+		return -1;
+	}
+
+	ub->sd = sd;
+
+	nfp_channel_param_init(&param);
+	param.method = NFP_CHANNEL_METHOD_TAKE;
+	param.ua_location = NFP_CHANNEL_UA_LOCATION_PKT_UA;
+	param.queue_param.enq_mode = ODP_QUEUE_OP_MT;
+	if (single_consumer)
+		param.queue_param.deq_mode = ODP_QUEUE_OP_MT_UNSAFE;
+
+	snprintf(name, sizeof(name), "udp_burst_%d", sd);
+	ub->chn = nfp_channel_create(name, &param);
+	if (ub->chn == NFP_CHANNEL_INVALID) {
+		NFP_ERR("Error: Failed to create channel %s", name);
+		return -1;
+	}
+
+	memset(&ev, 0, sizeof(ev));
+	ev.sigev_notify = NFP_SIGEV_HOOK;
+	ev.sigev_notify_func = udp_burst_notify;
+	ev.sigev_value.sival_ptr = ub;
+
+	if (nfp_socket_sigevent(sd, &ev) == -1) {
+		NFP_ERR("Error: Failed configure socket callback: "
+			"errno = %s", nfp_strerror(nfp_errno));
+		nfp_channel_destroy(ub->chn);
+		ub->chn = NFP_CHANNEL_INVALID;
+		return -1;
+	}
+
+	return 0;
+}
+
+int nfpexpl_udp_burst_term(nfpexpl_udp_burst_t *ub)
+{
+	odp_packet_t pkt[UDP_BURST_DRAIN_MAX];
+	int num;
+
+	if (!ub || ub->chn == NFP_CHANNEL_INVALID)
+		return 0;
+
+	do {
+		num = nfp_channel_recv(ub->chn, pkt, NULL, 0,
+				       UDP_BURST_DRAIN_MAX);
+		if (num > 0)
+			odp_packet_free_multi(pkt, num);
+	} while (num > 0);
+
+	if (nfp_channel_destroy(ub->chn) < 0)
+		return -1;
+
+	ub->chn = NFP_CHANNEL_INVALID;
+	return 0;
+}
+
+int nfpexpl_udp_packet_recv_multi(nfpexpl_udp_burst_t *ub, odp_packet_t pkt[],
+				  struct nfp_sockaddr_in addr[], int num)
+{
+	if (!ub || !pkt || num < 0)
+		return -1;
+
+	return nfp_channel_recv(ub->chn, pkt, (uint8_t *)addr,
+				sizeof(struct nfp_sockaddr_in), num);
+}
+
+int nfpexpl_udp_packet_sendto_multi(int sd, odp_packet_t pkt[],
+				    const struct nfp_sockaddr_in addr[],
+				    int num)
+{
+	int i;
+
+	for (i = 0; i < num; i++) {
+		if (nfp_udp_packet_sendto(sd, pkt[i],
+			addr ? (const struct nfp_sockaddr *)&addr[i] : NULL,
+			addr ? sizeof(addr[i]) : 0) < 0)
+			return i ? i : -1;
+	}
+
+	return num;
+}
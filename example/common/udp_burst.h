@@ -0,0 +1,84 @@
+/* Copyright (c) 2026, Bogdan Pricope
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:	BSD-3-Clause
+ */
+
+#ifndef __NFP_EXAMPLE_UDP_BURST__
+#define __NFP_EXAMPLE_UDP_BURST__
+
+#include "nfp.h"
+
+/**
+ * Zero-copy UDP burst receive context of a socket
+ */
+typedef struct {
+	/** Socket descriptor */
+	int sd;
+
+	/** Channel receiving the datagrams of the socket */
+	nfp_channel_t chn;
+} nfpexpl_udp_burst_t;
+
+/**
+ * Enable zero-copy burst receive on a UDP socket.
+ *
+ * The datagrams received on the socket are taken out of the stack by a
+ * NFP_SIGEV_HOOK notification function and queued, together with the
+ * source address, on a packet channel. The packet data pointer is set to
+ * the UDP payload (see nfp_udp_packet_parse()). The socket receive
+ * buffer is not used anymore.
+ *
+ * @param[out] ub  Burst receive context
+ * @param sd       UDP socket descriptor
+ * @param single_consumer  The datagrams are received by a single thread:
+ *                 the channel is dequeued in ODP_QUEUE_OP_MT_UNSAFE mode
+ * @return 0 on success, -1 on error
+ */
+int nfpexpl_udp_burst_init(nfpexpl_udp_burst_t *ub, int sd,
+			   odp_bool_t single_consumer);
+
+/**
+ * Release the burst receive context of a socket.
+ *
+ * The queued packets are freed. Call it after closing the socket.
+ *
+ * @param ub  Burst receive context
+ * @return 0 on success, -1 on error
+ */
+int nfpexpl_udp_burst_term(nfpexpl_udp_burst_t *ub);
+
+/**
+ * Receive a burst of UDP datagrams as packets.
+ *
+ * Dequeues up to 'num' datagrams in one call. The application owns the
+ * returned packets: free them or send them (e.g. with
+ * nfpexpl_udp_packet_sendto_multi()).
+ *
+ * @param ub         Burst receive context
+ * @param[out] pkt   Array of 'num' packets
+ * @param[out] addr  Array of 'num' source addresses, or NULL
+ * @param num        Maximum number of datagrams to receive
+ * @return Number of datagrams received, -1 on error
+ */
+int nfpexpl_udp_packet_recv_multi(nfpexpl_udp_burst_t *ub, odp_packet_t pkt[],
+				  struct nfp_sockaddr_in addr[], int num);
+
+/**
+ * Send a burst of packets as UDP datagrams.
+ *
+ * Calls nfp_udp_packet_sendto() for each packet. The packets not sent
+ * are left to the caller.
+ *
+ * @param sd    UDP socket descriptor
+ * @param pkt   Array of 'num' packets, data pointer set to the UDP payload
+ * @param addr  Array of 'num' destination addresses, or NULL if the socket
+ *              is connected
+ * @param num   Number of packets
+ * @return Number of packets sent, -1 if none was sent (nfp_errno is set)
+ */
+int nfpexpl_udp_packet_sendto_multi(int sd, odp_packet_t pkt[],
+				    const struct nfp_sockaddr_in addr[],
+				    int num);
+
+#endif /* __NFP_EXAMPLE_UDP_BURST__ */
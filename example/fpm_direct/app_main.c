@@ -12,6 +12,7 @@
 #include "nfp.h"
 #include "linux_sigaction.h"
 #include "cli_arg_parse.h"
+#include "pkt_dispatcher.h"
 
 #define MAX_WORKERS		64
 #define PKT_BURST_SIZE NFP_PKT_VECTOR_SIZE
@@ -29,14 +30,12 @@ typedef struct {
 	appl_arg_ifs_t itf_param;
 	char *cli_file;
 	odp_bool_t single_pkt_API;
+	int burst_size;
+	uint64_t tx_deadline;
+	uint64_t idle_wait;
+	int prefetch_depth;
 } appl_args_t;
 
-struct worker_arg {
-	int num_pktin;
-	odp_pktin_queue_t pktin[NFP_FP_INTERFACE_MAX];
-	odp_bool_t process_timers;
-};
-
 struct interface_id {
 	int port;
 	uint16_t subport;
@@ -50,182 +49,6 @@ static void usage(char *progname);
 static int validate_cores_settings(int req_core_start, int req_core_count,
 	int *core_start, int *core_count);
 
-/** pkt_io_recv_single() Custom event dispatcher
- *
- * @param _arg void*  Worker argument
- * @return int Never returns
- *
- */
-static int pkt_io_recv_single(void *_arg)
-{
-	odp_queue_t in_queue;
-	odp_packet_t pkt, pkt_tbl[PKT_BURST_SIZE];
-	odp_event_t events[PKT_BURST_SIZE], ev;
-	int pkt_idx, pkt_cnt, event_cnt;
-	struct worker_arg *arg;
-	int num_pktin, i;
-	odp_pktin_queue_t pktin[NFP_FP_INTERFACE_MAX];
-	uint8_t *ptr;
-	odp_bool_t process_timers;
-	odp_bool_t *is_running = NULL;
-
-	arg = (struct worker_arg *)_arg;
-	process_timers = arg->process_timers;
-	num_pktin = arg->num_pktin;
-
-	for (i = 0; i < num_pktin; i++)
-		pktin[i] = arg->pktin[i];
-
-	is_running = nfp_get_processing_state();
-	if (is_running == NULL) {
-		NFP_ERR("nfp_get_processing_state failed");
-		return -1;
-	}
-
-	ptr = (uint8_t *)&pktin[0];
-
-	printf("PKT-IO receive starting on cpu: %i, %i, %x:%x\n", odp_cpu_id(),
-	       num_pktin, ptr[0], ptr[8]);
-
-	while (*is_running) {
-		if (process_timers) {
-			event_cnt = odp_schedule_multi(&in_queue,
-						       ODP_SCHED_NO_WAIT,
-						       events, PKT_BURST_SIZE);
-			for (i = 0; i < event_cnt; i++) {
-				ev = events[i];
-
-				if (ev == ODP_EVENT_INVALID)
-					continue;
-
-				if (odp_event_type(ev) == ODP_EVENT_TIMEOUT)
-					nfp_timer_handle(ev);
-				else if (odp_event_type(ev) == ODP_EVENT_PACKET)
-					nfp_packet_input(/*loopbacked, SP pkts*/
-						odp_packet_from_event(ev),
-						in_queue,
-						nfp_eth_vlan_processing);
-				else
-					odp_event_free(ev);
-			}
-		}
-		for (i = 0; i < num_pktin; i++) {
-			pkt_cnt = odp_pktin_recv(pktin[i], pkt_tbl,
-						 PKT_BURST_SIZE);
-
-			for (pkt_idx = 0; pkt_idx < pkt_cnt; pkt_idx++) {
-				pkt = pkt_tbl[pkt_idx];
-
-				nfp_packet_input(pkt, ODP_QUEUE_INVALID,
-						 nfp_eth_vlan_processing);
-			}
-		}
-		nfp_send_pending_pkt();
-	}
-
-	/* Never reached */
-	return 0;
-}
-
-/** pkt_io_recv() Custom event dispatcher
- *
- * @param _arg void*  Worker argument
- * @return int Never returns
- *
- */
-static int pkt_io_recv(void *_arg)
-{
-	odp_queue_t in_queue;
-	odp_packet_t pkt, pkt_tbl[PKT_BURST_SIZE];
-	odp_event_t events[PKT_BURST_SIZE], ev;
-	int pkt_idx, pkt_cnt, event_cnt;
-	struct worker_arg *arg;
-	int num_pktin, i;
-	odp_pktin_queue_t pktin[NFP_FP_INTERFACE_MAX];
-	uint8_t *ptr;
-	odp_bool_t process_timers;
-	odp_bool_t *is_running = NULL;
-	nfp_pkt_vector_t vec;
-
-	arg = (struct worker_arg *)_arg;
-	process_timers = arg->process_timers;
-	num_pktin = arg->num_pktin;
-
-	for (i = 0; i < num_pktin; i++)
-		pktin[i] = arg->pktin[i];
-
-	is_running = nfp_get_processing_state();
-	if (is_running == NULL) {
-		NFP_ERR("nfp_get_processing_state failed");
-		return -1;
-	}
-
-	ptr = (uint8_t *)&pktin[0];
-
-	nfp_pkt_vector_init(&vec);
-
-	printf("PKT-IO receive starting on cpu: %i, %i, %x:%x\n", odp_cpu_id(),
-	       num_pktin, ptr[0], ptr[8]);
-
-	while (*is_running) {
-		if (process_timers) {
-			event_cnt = odp_schedule_multi(&in_queue,
-						       ODP_SCHED_NO_WAIT,
-						       events, PKT_BURST_SIZE);
-			for (i = 0; i < event_cnt; i++) {
-				ev = events[i];
-
-				if (ev == ODP_EVENT_INVALID)
-					continue;
-
-				if (odp_event_type(ev) == ODP_EVENT_TIMEOUT) {
-					nfp_timer_handle(ev);
-					continue;
-				} else if (odp_event_type(ev) ==
-						ODP_EVENT_PACKET) {
-					nfp_packet_input(/*loopbacked, SP pkts*/
-						odp_packet_from_event(ev),
-						in_queue,
-						nfp_eth_vlan_processing);
-					continue;
-				}
-
-				odp_event_free(ev);
-			}
-		}
-		for (i = 0; i < num_pktin; i++) {
-			pkt_cnt = odp_pktin_recv(pktin[i], pkt_tbl,
-						 PKT_BURST_SIZE);
-
-			for (pkt_idx = 0; pkt_idx < pkt_cnt; pkt_idx++) {
-				pkt = pkt_tbl[pkt_idx];
-
-				if (nfp_pkt_vector_add(&vec, pkt) != 1) {
-					odp_packet_free(pkt);
-					continue;
-				}
-
-				if (NFP_PKT_VECTOR_IS_FULL(&vec)) {
-					nfp_packet_input_multi(&vec, ODP_QUEUE_INVALID,
-							       nfp_eth_vlan_processing_multi);
-
-					nfp_pkt_vector_init(&vec);
-				}
-			}
-		}
-		if (NFP_PKT_VECTOR_HAS_DATA(&vec)) {
-			nfp_packet_input_multi(&vec, ODP_QUEUE_INVALID,
-					       nfp_eth_vlan_processing_multi);
-
-			nfp_pkt_vector_init(&vec);
-		}
-		nfp_send_pending_pkt();
-	}
-
-	/* Never reached */
-	return 0;
-}
-
 /** configure_interfaces() Create NFP interfaces with
  * pktios open in direct mode, thread unsafe.
  *
@@ -357,7 +180,12 @@ static int configure_interface_addresses(appl_arg_ifs_t *itf_param,
  *  argument
  *
  * @param num_workers int  Number of workers
- * @param workers_arg struct worker_arg* Array of workers
+ * @param burst_size int  Number of packets received at once
+ * @param tx_deadline uint64_t  Transmit flush deadline (ns)
+ * @param single_pkt_API odp_bool_t  Use single packet processing API
+ * @param idle_wait uint64_t  Maximum idle wait (ns), 0 for busy-polling
+ * @param prefetch_depth int  Number of packets prefetched ahead
+ * @param workers_arg nfpexpl_dispatcher_param_t* Array of workers
  *    argument
  * @param if_count int  Interface count
  * @param if_names char** Interface names
@@ -365,19 +193,33 @@ static int configure_interface_addresses(appl_arg_ifs_t *itf_param,
  *
  */
 static int configure_workers_arg(appl_arg_ifs_t *itf_param,
-				 int num_workers,
-				 struct worker_arg *workers_arg)
+				 int num_workers, int burst_size,
+				 uint64_t tx_deadline,
+				 odp_bool_t single_pkt_API, uint64_t idle_wait,
+				 int prefetch_depth,
+				 nfpexpl_dispatcher_param_t *workers_arg)
 {
 	odp_pktio_t pktio;
 	odp_pktin_queue_t pktin[MAX_WORKERS];
 	int i, j;
 
 	for (i = 0; i < num_workers; i++) {
+		nfpexpl_dispatcher_param_init(&workers_arg[i]);
 		workers_arg[i].num_pktin = itf_param->if_count;
 		workers_arg[i].process_timers = 0;
+		workers_arg[i].burst_size = burst_size;
+		workers_arg[i].tx_deadline = tx_deadline;
+		workers_arg[i].idle_wait_max = idle_wait;
+		workers_arg[i].prefetch_depth = prefetch_depth;
+		if (idle_wait && idle_wait < workers_arg[i].idle_wait_min)
+			workers_arg[i].idle_wait_min = idle_wait;
+		if (single_pkt_API)
+			workers_arg[i].pkt_multi_func = NULL;
 	}
 	/*enable timer processing on first core*/
 	workers_arg[0].process_timers = 1;
+	/*timer processing core does not wait for packets*/
+	workers_arg[0].idle_wait_max = 0;
 
 	for (i = 0; i < itf_param->if_count; i++) {
 		pktio = odp_pktio_lookup(itf_param->if_array[i].if_name);
@@ -413,7 +255,7 @@ int main(int argc, char *argv[])
 	nfp_initialize_param_t app_init_params;
 	nfp_thread_t thread_tbl[MAX_WORKERS];
 	nfp_thread_param_t thread_param;
-	struct worker_arg workers_arg[MAX_WORKERS];
+	nfpexpl_dispatcher_param_t workers_arg[MAX_WORKERS];
 	struct interface_id itf_id[NFP_FP_INTERFACE_MAX];
 	int num_workers, first_worker, linux_sp_core, i, ret_val;
 	odp_cpumask_t cpu_mask;
@@ -440,8 +282,8 @@ int main(int argc, char *argv[])
 
 	/* Initialize NFP*/
 	nfp_initialize_param(&app_init_params);
-	app_init_params.evt_rx_burst_size = NFP_PKT_VECTOR_SIZE;
-	app_init_params.pkt_tx_burst_size = NFP_PKT_VECTOR_SIZE;
+	app_init_params.evt_rx_burst_size = params.burst_size;
+	app_init_params.pkt_tx_burst_size = params.burst_size;
 	app_init_params.linux_core_id = linux_sp_core;
 	app_init_params.cli.os_thread.start_on_init = 1;
 
@@ -475,8 +317,10 @@ int main(int argc, char *argv[])
 		exit(EXIT_FAILURE);
 	}
 
-	if (configure_workers_arg(&params.itf_param,
-				  num_workers, workers_arg)) {
+	if (configure_workers_arg(&params.itf_param, num_workers,
+				  params.burst_size, params.tx_deadline,
+				  params.single_pkt_API, params.idle_wait,
+				  params.prefetch_depth, workers_arg)) {
 		NFP_ERR("Failed to initialize workers arguments.");
 		nfp_terminate();
 		parse_args_cleanup(&params);
@@ -487,10 +331,7 @@ int main(int argc, char *argv[])
 	memset(thread_tbl, 0, sizeof(thread_tbl));
 	for (i = 0; i < num_workers; ++i) {
 		nfp_thread_param_init(&thread_param);
-		if (params.single_pkt_API)
-			thread_param.start = pkt_io_recv_single;
-		else
-			thread_param.start = pkt_io_recv;
+		thread_param.start = nfpexpl_direct_dispatcher;
 		thread_param.arg = &workers_arg[i];
 		thread_param.thr_type = ODP_THREAD_WORKER;
 
@@ -537,6 +378,13 @@ int main(int argc, char *argv[])
 
 	nfp_thread_join(thread_tbl, num_workers);
 
+	for (i = 0; i < num_workers; i++)
+		printf("Worker %d: busy cycles %" PRIu64 ", idle cycles %"
+		       PRIu64 ", idle waits %" PRIu64 "\n", i,
+		       workers_arg[i].stats.busy_cycles,
+		       workers_arg[i].stats.idle_cycles,
+		       workers_arg[i].stats.idle_waits);
+
 	if (nfp_terminate() < 0)
 		printf("Error: nfp_terminate failed.\n");
 
@@ -615,6 +463,10 @@ static int parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		{"cli-file", required_argument,
 			NULL, 'f'},/* return 'f' */
 		{"single-pkt-API", no_argument, NULL, 'g'},
+		{"burst-size", required_argument, NULL, 'b'},
+		{"tx-deadline", required_argument, NULL, 'd'},
+		{"idle-wait", required_argument, NULL, 'w'},
+		{"prefetch", required_argument, NULL, 'p'},
 		{NULL, 0, NULL, 0}
 	};
 
@@ -622,9 +474,13 @@ static int parse_args(int argc, char *argv[], appl_args_t *appl_args)
 	appl_args->core_start = 1;
 	appl_args->core_count = 0; /* all above core start */
 	appl_args->single_pkt_API = 0;
+	appl_args->burst_size = PKT_BURST_SIZE;
+	appl_args->tx_deadline = 0;
+	appl_args->idle_wait = 0;
+	appl_args->prefetch_depth = 4;
 
 	while (res == 0) {
-		opt = getopt_long(argc, argv, "+c:s:i:hf:g",
+		opt = getopt_long(argc, argv, "+c:s:i:hf:gb:d:w:p:",
 				  longopts, &long_index);
 
 		if (opt == -1)
@@ -676,6 +532,36 @@ static int parse_args(int argc, char *argv[], appl_args_t *appl_args)
 			appl_args->single_pkt_API = 1;
 			break;
 
+		case 'b':
+			appl_args->burst_size = atoi(optarg);
+			if (appl_args->burst_size < 1 ||
+			    appl_args->burst_size > PKT_BURST_SIZE) {
+				printf("Error: Invalid burst size: %s "
+				       "(1 - %d)\n", optarg, PKT_BURST_SIZE);
+				usage(argv[0]);
+				res = -1;
+			}
+			break;
+
+		case 'd':
+			appl_args->tx_deadline = strtoull(optarg, NULL, 0);
+			break;
+
+		case 'w':
+			appl_args->idle_wait = strtoull(optarg, NULL, 0);
+			break;
+
+		case 'p':
+			appl_args->prefetch_depth = atoi(optarg);
+			if (appl_args->prefetch_depth < 0 ||
+			    appl_args->prefetch_depth > PKT_BURST_SIZE) {
+				printf("Error: Invalid prefetch depth: %s "
+				       "(0 - %d)\n", optarg, PKT_BURST_SIZE);
+				usage(argv[0]);
+				res = -1;
+			}
+			break;
+
 		default:
 			break;
 		}
@@ -742,8 +628,14 @@ static void print_info(char *progname, appl_args_t *appl_args)
 		printf(" %s", appl_args->itf_param.if_array[i].if_name);
 	printf("\n\n");
 
-	printf("Packet processing API: %s\n\n", appl_args->single_pkt_API ?
+	printf("Packet processing API: %s\n", appl_args->single_pkt_API ?
 	       "single" : "multi");
+	printf("Burst size:            %d\n", appl_args->burst_size);
+	printf("TX flush deadline(ns): %" PRIu64 "\n",
+	       appl_args->tx_deadline);
+	printf("Max idle wait(ns):     %" PRIu64 "\n",
+	       appl_args->idle_wait);
+	printf("Prefetch depth:        %d\n\n", appl_args->prefetch_depth);
 
 	fflush(NULL);
 }
@@ -771,7 +663,19 @@ static void usage(char *progname)
 		   "  -c, --core_count <number> Core count. Default 0: all above core start\n"
 		   "  -f, --cli-file <file> NFP CLI file.\n"
 		   "  -g, --single-pkt-API  Use single packet processing API\n"
+		   "  -b, --burst-size <number> Number of packets received and\n"
+		   "      processed at once (1 - %d). Default %d.\n"
+		   "  -d, --tx-deadline <ns> Maximum time to keep packets\n"
+		   "      for a larger transmit burst while receiving.\n"
+		   "      Default 0: send on every loop iteration.\n"
+		   "  -w, --idle-wait <ns> Hybrid poll/wait mode: maximum time\n"
+		   "      to wait for packets when idle, with progressive\n"
+		   "      backoff. The timer core never waits.\n"
+		   "      Default 0: busy-polling.\n"
+		   "  -p, --prefetch <number> Number of received packets\n"
+		   "      prefetched ahead (0 - %d). Default 4.\n"
 		   "  -h, --help           Display help and exit.\n"
-		   "\n", NO_PATH(progname), NO_PATH(progname)
+		   "\n", NO_PATH(progname), NO_PATH(progname),
+		   PKT_BURST_SIZE, PKT_BURST_SIZE, PKT_BURST_SIZE
 		);
 }
@@ -21,3 +21,14 @@ int setup_common_vars(void)
 
 	return 0;
 }
+
+/* Wait for a NFP socket to become writable, for up to 100us */
+void netwrap_send_wait(int fd)
+{
+	nfp_fd_set wfds;
+	struct nfp_timeval tv = {0, 100};
+
+	NFP_FD_ZERO(&wfds);
+	NFP_FD_SET(fd, &wfds);
+	nfp_select(fd + 1, NULL, &wfds, NULL, &tv);
+}
@@ -18,6 +18,7 @@
 #include <nfp.h>
 
 int setup_common_vars(void);
+void netwrap_send_wait(int fd);
 extern nfp_initialize_param_t nfp_global_params;
 extern odp_bool_t netwrap_constructor_called;
 
@@ -8,19 +8,30 @@
 #include "netwrap_common.h"
 #include <sys/time.h>
 #include <sys/types.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 #include <odp_api.h>
 #include "nfp.h"
 #include "netwrap_select.h"
 #include "netwrap_errno.h"
 
+/* Number of poll() entries converted on the stack */
+#define NETWRAP_POLL_FDS_MAX 64
+
+/* Interval between two checks of a poll() set (us) */
+#define NETWRAP_POLL_INTERVAL 100
+
 static int (*libc_select)(int, fd_set *, fd_set *, fd_set *,
 	struct timeval *);
+static int (*libc_poll)(struct pollfd *, nfds_t, int);
 
 
 void setup_select_wrappers(void)
 {
 	LIBC_FUNCTION(select);
+	LIBC_FUNCTION(poll);
 }
 
 int select(int nfds, fd_set *readfds, fd_set *writefds,
@@ -110,3 +121,167 @@ int select(int nfds, fd_set *readfds, fd_set *writefds,
 		nfds, select_value);*/
 	return select_value;
 }
+
+static short poll_events_to_nfp(short events)
+{
+	short nfp_events = 0;
+
+	if (events & POLLIN)
+		nfp_events |= NFP_POLLIN;
+	if (events & POLLPRI)
+		nfp_events |= NFP_POLLPRI;
+	if (events & (POLLOUT | POLLWRNORM))
+		nfp_events |= NFP_POLLOUT;
+	if (events & POLLRDNORM)
+		nfp_events |= NFP_POLLRDNORM;
+
+	return nfp_events;
+}
+
+static short poll_events_from_nfp(short nfp_revents, short events)
+{
+	short revents = 0;
+
+	if (nfp_revents & NFP_POLLIN)
+		revents |= POLLIN;
+	if (nfp_revents & NFP_POLLPRI)
+		revents |= POLLPRI;
+	if (nfp_revents & NFP_POLLOUT)
+		revents |= events & (POLLOUT | POLLWRNORM);
+	if (nfp_revents & NFP_POLLRDNORM)
+		revents |= POLLRDNORM;
+	if (nfp_revents & NFP_POLLERR)
+		revents |= POLLERR;
+	if (nfp_revents & NFP_POLLHUP)
+		revents |= POLLHUP;
+	if (nfp_revents & NFP_POLLNVAL)
+		revents |= POLLNVAL;
+
+	return revents;
+}
+
+static uint64_t poll_time_usec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000UL + ts.tv_nsec / 1000;
+}
+
+/* The NFP and Linux entries of a poll() set are split in two sets with the
+ * same layout (fd -1 for the entries of the other side). A set of NFP
+ * sockets only is passed to nfp_poll() with the timeout. Otherwise, both
+ * sets are checked one after the other without waiting until an event is
+ * found or the timeout expires. */
+static int poll_split(struct pollfd *fds, nfds_t nfds, int timeout,
+		      struct nfp_pollfd *nfp_fds, struct pollfd *linux_fds)
+{
+	nfds_t i, num_linux = 0;
+	uint64_t start = 0;
+	int nfp_ret, linux_ret = 0;
+
+	for (i = 0; i < nfds; i++) {
+		if (fds[i].fd >= 0 && IS_NFP_SOCKET(fds[i].fd)) {
+			nfp_fds[i].fd = fds[i].fd;
+			nfp_fds[i].events = poll_events_to_nfp(fds[i].events);
+			linux_fds[i].fd = -1;
+		} else {
+			nfp_fds[i].fd = -1;
+			linux_fds[i].fd = fds[i].fd;
+			linux_fds[i].events = fds[i].events;
+			if (fds[i].fd >= 0)
+				num_linux++;
+		}
+	}
+
+	if (num_linux == 0) {
+		nfp_ret = nfp_poll(nfp_fds, nfds, timeout);
+		if (nfp_ret < 0) {
+			errno = NETWRAP_ERRNO(nfp_errno);
+			return -1;
+		}
+	} else {
+		if (timeout > 0)
+			start = poll_time_usec();
+
+		do {
+			nfp_ret = nfp_poll(nfp_fds, nfds, 0);
+			if (nfp_ret < 0) {
+				errno = NETWRAP_ERRNO(nfp_errno);
+				return -1;
+			}
+
+			linux_ret = (*libc_poll)(linux_fds, nfds, 0);
+			if (linux_ret < 0)
+				return -1;
+
+			if (nfp_ret || linux_ret || timeout == 0)
+				break;
+
+			if (timeout > 0 && poll_time_usec() - start >=
+			    (uint64_t)timeout * 1000)
+				break;
+
+			usleep(NETWRAP_POLL_INTERVAL);
+		} while (1);
+	}
+
+	for (i = 0; i < nfds; i++) {
+		if (nfp_fds[i].fd >= 0)
+			fds[i].revents = poll_events_from_nfp(
+				nfp_fds[i].revents, fds[i].events);
+		else if (linux_fds[i].fd >= 0)
+			fds[i].revents = linux_fds[i].revents;
+		else
+			fds[i].revents = 0;
+	}
+
+	return nfp_ret + linux_ret;
+}
+
+int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+	struct nfp_pollfd nfp_fds_local[NETWRAP_POLL_FDS_MAX];
+	struct pollfd linux_fds_local[NETWRAP_POLL_FDS_MAX];
+	struct nfp_pollfd *nfp_fds = nfp_fds_local;
+	struct pollfd *linux_fds = linux_fds_local;
+	odp_bool_t has_nfp = 0;
+	nfds_t i;
+	int poll_value;
+
+	if (!libc_poll) {
+		LIBC_FUNCTION(poll);
+
+		if (!libc_poll) {
+			errno = EACCES;
+			return -1;
+		}
+	}
+
+	for (i = 0; i < nfds && !has_nfp; i++)
+		if (fds[i].fd >= 0 && IS_NFP_SOCKET(fds[i].fd))
+			has_nfp = 1;
+
+	if (!has_nfp)
+		return (*libc_poll)(fds, nfds, timeout);
+
+	if (nfds > NETWRAP_POLL_FDS_MAX) {
+		nfp_fds = malloc(nfds * sizeof(*nfp_fds));
+		linux_fds = malloc(nfds * sizeof(*linux_fds));
+		if (!nfp_fds || !linux_fds) {
+			free(nfp_fds);
+			free(linux_fds);
+			errno = ENOMEM;
+			return -1;
+		}
+	}
+
+	poll_value = poll_split(fds, nfds, timeout, nfp_fds, linux_fds);
+
+	if (nfp_fds != nfp_fds_local) {
+		free(nfp_fds);
+		free(linux_fds);
+	}
+
+	return poll_value;
+}
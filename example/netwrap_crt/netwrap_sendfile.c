@@ -8,6 +8,8 @@
 #include "netwrap_common.h"
 #include <sys/types.h>
 #include <sys/sendfile.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <odp_api.h>
 #include "nfp.h"
@@ -25,6 +27,89 @@ void setup_sendfile_wrappers(void)
 }
 
 #define BUF_SIZE 1024
+/* Size of the file window mapped at once */
+#define MAP_SIZE (1024 * 1024)
+/*
+ * Send 'len' bytes, waiting while the socket send buffer is full. Returns the
+ * number of bytes sent: less than 'len' on error (errno is set).
+ */
+static size_t send_all(int fd, const char *buf, size_t len)
+{
+	nfp_ssize_t nfp_data_sent;
+	size_t nfp_data_sent_sum = 0;
+
+	while (nfp_data_sent_sum < len) {
+		nfp_data_sent = nfp_send(fd, buf + nfp_data_sent_sum,
+					 len - nfp_data_sent_sum, 0);
+		if (nfp_data_sent < 0) {
+			if (nfp_errno == NFP_EWOULDBLOCK) {
+				netwrap_send_wait(fd);
+				continue;
+			}
+			errno = NETWRAP_ERRNO(nfp_errno);
+			break;
+		}
+		nfp_data_sent_sum += nfp_data_sent;
+	}
+
+	return nfp_data_sent_sum;
+}
+
+/*
+ * Send file data directly from a mapping of the file, without the bounce
+ * copy into a stack buffer. Returns the number of bytes sent, -1 on error
+ * or -2 if the file cannot be mapped (not a regular file, a file without
+ * size, e.g. procfs/sysfs, or a filesystem without mmap support).
+ *
+ * Unlike Linux sendfile(), a file truncated by another process while it is
+ * sent raises SIGBUS when the missing pages are accessed. The file size is
+ * checked before each window, which narrows but does not close this window.
+ */
+static ssize_t sendfile_mmap(int out_fd, int in_fd, off_t offset, size_t count)
+{
+	long page_size = sysconf(_SC_PAGESIZE);
+	struct stat st;
+	size_t data_processed = 0, len, delta, sent;
+	off_t pos, map_offset;
+	char *map;
+
+	if (page_size <= 0 || fstat(in_fd, &st) || !S_ISREG(st.st_mode) ||
+	    st.st_size == 0)
+		return -2;
+
+	while (data_processed < count) {
+		pos = offset + data_processed;
+		if (data_processed && fstat(in_fd, &st))
+			break;
+		if (pos >= st.st_size)
+			break;
+
+		map_offset = pos & ~((off_t)page_size - 1);
+		delta = pos - map_offset;
+
+		len = count - data_processed;
+		if (len > (size_t)(st.st_size - pos))
+			len = st.st_size - pos;
+		if (len > MAP_SIZE)
+			len = MAP_SIZE;
+
+		map = mmap(NULL, len + delta, PROT_READ, MAP_SHARED, in_fd,
+			   map_offset);
+		if (map == MAP_FAILED)
+			return data_processed ? (ssize_t)data_processed : -2;
+		madvise(map, len + delta, MADV_SEQUENTIAL);
+
+		sent = send_all(out_fd, map + delta, len);
+		munmap(map, len + delta);
+
+		/* Report the bytes already sent, even on error */
+		data_processed += sent;
+		if (sent < len)
+			return data_processed ? (ssize_t)data_processed : -1;
+	}
+
+	return data_processed;
+}
 
 ssize_t sendfile64(int out_fd, int in_fd, off64_t *offset, size_t count)
 {
@@ -32,14 +117,29 @@ ssize_t sendfile64(int out_fd, int in_fd, off64_t *offset, size_t count)
 
 	if (IS_NFP_SOCKET(out_fd)) {
 		off_t orig = 0;
-		size_t data_processed = 0;
+		size_t data_processed = 0, sent;
 		char buff[BUF_SIZE];
 		ssize_t data_read;
-		nfp_ssize_t nfp_data_sent;
-		nfp_ssize_t nfp_data_sent_sum;
 
+		orig = lseek(in_fd, 0, SEEK_CUR);
+		if (offset != NULL || orig != (off_t)-1) {
+			sendfile_value = sendfile_mmap(out_fd, in_fd,
+					offset ? *offset : orig, count);
+			if (sendfile_value >= 0) {
+				/* Update the offset or the file position */
+				if (offset != NULL)
+					*offset += sendfile_value;
+				else if (lseek(in_fd, orig + sendfile_value,
+					       SEEK_SET) == -1)
+					return -1;
+				return sendfile_value;
+			}
+			if (sendfile_value == -1)
+				return -1;
+		}
+
+		/* File not mapped: read and send */
 		if (offset != NULL) {
-			orig = lseek(in_fd, 0, SEEK_CUR);
 			if (orig == (off_t)-1)
 				return -1;
 			if (lseek(in_fd, *offset, SEEK_SET) == -1)
@@ -47,36 +147,34 @@ ssize_t sendfile64(int out_fd, int in_fd, off64_t *offset, size_t count)
 		}
 
 		while (data_processed < count) {
-			data_read = (*libc_read)(in_fd, buff, BUF_SIZE);
-			if (data_read < 0)
+			data_read = (*libc_read)(in_fd, buff,
+				count - data_processed < BUF_SIZE ?
+				count - data_processed : BUF_SIZE);
+			if (data_read < 0) {
+				if (data_processed)
+					break;
 				return -1;
-			else if (data_read == 0)   /*EOF*/
+			} else if (data_read == 0) {   /*EOF*/
 				break;
+			}
 
-			nfp_data_sent_sum = 0;
-			while (nfp_data_sent_sum < data_read) {
-				nfp_data_sent = nfp_send(out_fd,
-					buff + nfp_data_sent_sum,
-					data_read - nfp_data_sent_sum, 0);
-				if (nfp_data_sent < 0) {
-					if (nfp_errno == NFP_EWOULDBLOCK) {
-						usleep(100);
-						continue;
-					}
-					errno = NETWRAP_ERRNO(nfp_errno);
-					return -1;
-				}
-				nfp_data_sent_sum += nfp_data_sent;
+			sent = send_all(out_fd, buff, data_read);
+			data_processed += sent;
+			if (sent < (size_t)data_read) {
+				/* Give back the data read but not sent */
+				if (orig != (off_t)-1)
+					lseek(in_fd, (off_t)sent - data_read,
+					      SEEK_CUR);
+				if (data_processed)
+					break;
+				return -1;
 			}
-			data_processed += data_read;
 		}
 
 		sendfile_value = data_processed;
 
 		if (offset != NULL) {
-			*offset = lseek(in_fd, 0, SEEK_CUR);
-			if (*offset == -1)
-				return -1;
+			*offset += data_processed;
 			if (lseek(in_fd, orig, SEEK_SET) == -1)
 				return -1;
 		}
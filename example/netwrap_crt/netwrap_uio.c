@@ -6,55 +6,98 @@
  */
 
 #include "netwrap_common.h"
+#include <limits.h>
+#include <string.h>
 #include <sys/uio.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 #include <unistd.h>
 #include <odp_api.h>
 #include "nfp.h"
 #include "netwrap_uio.h"
 #include "netwrap_errno.h"
 
+/* Maximum number of messages handled by a recvmmsg()/sendmmsg() call */
+#define NETWRAP_MMSG_MAX 32
+
 static ssize_t (*libc_writev)(int, const struct iovec *, int);
+static ssize_t (*libc_readv)(int, const struct iovec *, int);
+static int (*libc_recvmmsg)(int, struct mmsghdr *, unsigned int, int,
+			    struct timespec *);
+static int (*libc_sendmmsg)(int, struct mmsghdr *, unsigned int, int);
 
 void setup_uio_wrappers(void)
 {
 	LIBC_FUNCTION(writev);
+	LIBC_FUNCTION(readv);
+	LIBC_FUNCTION(recvmmsg);
+	LIBC_FUNCTION(sendmmsg);
 }
 
 
+static int iovec_to_nfp(const struct iovec *iov, int iovcnt,
+			struct nfp_iovec *nfp_iov)
+{
+	int i;
+
+	if (iovcnt < 0 || iovcnt > IOV_MAX) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (iovcnt && !iov) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	for (i = 0; i < iovcnt; i++) {
+		nfp_iov[i].iov_base = iov[i].iov_base;
+		nfp_iov[i].iov_len = (nfp_size_t)iov[i].iov_len;
+	}
+
+	return 0;
+}
+
 ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
 {
 	ssize_t writev_value = -1;
 
 	if (IS_NFP_SOCKET(fd)) {
-		int i;
+		struct nfp_iovec nfp_iov[IOV_MAX];
+		struct nfp_iovec *nfp_iov_crt = nfp_iov;
 		ssize_t writev_sum = 0;
-		nfp_size_t iov_len;
-		nfp_size_t iov_snt;
-		char *iov_base;
 		nfp_ssize_t nfp_send_res;
 
+		if (iovec_to_nfp(iov, iovcnt, nfp_iov))
+			return -1;
 
-		for (i = 0; i < iovcnt; i++) {
-			iov_len = iov[i].iov_len;
-			iov_snt = 0;
-			iov_base = (char *)iov[i].iov_base;
-
-			while (iov_snt < iov_len) {
-				nfp_send_res = nfp_send(fd, iov_base + iov_snt,
-					iov_len - iov_snt, 0);
-
-				if (nfp_send_res <= 0) {
-					if (nfp_send_res == 0 ||
-						nfp_errno == NFP_EAGAIN) {
-						usleep(100);
-						continue;
-					}
-					errno = NETWRAP_ERRNO(nfp_errno);
-					return -1;
+		while (iovcnt) {
+			nfp_send_res = nfp_writev(fd, nfp_iov_crt, iovcnt);
+			if (nfp_send_res < 0) {
+				if (nfp_errno == NFP_EAGAIN) {
+					netwrap_send_wait(fd);
+					continue;
 				}
-				iov_snt += nfp_send_res;
+				errno = NETWRAP_ERRNO(nfp_errno);
+				/* Report the data already sent */
+				return writev_sum ? writev_sum : -1;
+			}
+			writev_sum += nfp_send_res;
+
+			/* Skip the data sent */
+			while (iovcnt &&
+			       (nfp_size_t)nfp_send_res >= nfp_iov_crt->iov_len) {
+				nfp_send_res -= nfp_iov_crt->iov_len;
+				nfp_iov_crt++;
+				iovcnt--;
+			}
+			if (iovcnt) {
+				nfp_iov_crt->iov_base =
+					(char *)nfp_iov_crt->iov_base +
+					nfp_send_res;
+				nfp_iov_crt->iov_len -= nfp_send_res;
+				netwrap_send_wait(fd);
 			}
-			writev_sum += iov_len;
 		}
 		writev_value = writev_sum;
 	} else if (libc_writev)
@@ -72,3 +115,262 @@ ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
 
 	return writev_value;
 }
+
+ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
+{
+	ssize_t readv_value = -1;
+
+	if (IS_NFP_SOCKET(fd)) {
+		struct nfp_iovec nfp_iov[IOV_MAX];
+
+		if (iovec_to_nfp(iov, iovcnt, nfp_iov))
+			return -1;
+
+		readv_value = nfp_readv(fd, nfp_iov, iovcnt);
+		errno = NETWRAP_ERRNO(nfp_errno);
+	} else if (libc_readv)
+		readv_value = (*libc_readv)(fd, iov, iovcnt);
+	else {
+		LIBC_FUNCTION(readv);
+
+		if (libc_readv)
+			readv_value = (*libc_readv)(fd, iov, iovcnt);
+		else {
+			readv_value = -1;
+			errno = EACCES;
+		}
+	}
+
+	return readv_value;
+}
+
+static int recv_flags_to_nfp(int flags)
+{
+	int nfp_flags = 0;
+
+	if (flags & MSG_DONTWAIT)
+		nfp_flags |= NFP_MSG_DONTWAIT;
+	if (flags & MSG_OOB)
+		nfp_flags |= NFP_MSG_OOB;
+	if (flags & MSG_PEEK)
+		nfp_flags |= NFP_MSG_PEEK;
+	if (flags & MSG_TRUNC)
+		nfp_flags |= NFP_MSG_TRUNC;
+	if (flags & MSG_WAITALL)
+		nfp_flags |= NFP_MSG_WAITALL;
+	if (flags & MSG_WAITFORONE)
+		nfp_flags |= NFP_MSG_WAITFORONE;
+
+	return nfp_flags;
+}
+
+static int send_flags_to_nfp(int flags)
+{
+	int nfp_flags = 0;
+
+	if (flags & MSG_DONTROUTE)
+		nfp_flags |= NFP_MSG_DONTROUTE;
+	if (flags & MSG_DONTWAIT)
+		nfp_flags |= NFP_MSG_DONTWAIT;
+	if (flags & MSG_EOR)
+		nfp_flags |= NFP_MSG_EOR;
+	if (flags & MSG_NOSIGNAL)
+		nfp_flags |= NFP_MSG_NOSIGNAL;
+	if (flags & MSG_OOB)
+		nfp_flags |= NFP_MSG_OOB;
+
+	return nfp_flags;
+}
+
+/*
+ * Convert the message headers of an mmsghdr array to NFP message headers.
+ * Scatter/gather arrays are converted into 'nfp_iov' (IOV_MAX entries).
+ * Destination addresses (sendmmsg) are converted into 'nfp_addr'.
+ * Returns the number of converted messages, -1 on error (errno is set).
+ */
+static int mmsghdr_to_nfp(struct mmsghdr *msgvec, unsigned int vlen,
+			  struct nfp_mmsghdr *nfp_msgvec,
+			  struct nfp_iovec *nfp_iov,
+			  struct nfp_sockaddr_in *nfp_addr,
+			  odp_bool_t is_send)
+{
+	const struct sockaddr_in *addr;
+	struct msghdr *msg;
+	struct nfp_msghdr *nfp_msg;
+	unsigned int i;
+	int j, iov_cnt = 0;
+
+	if (!msgvec) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	if (vlen > NETWRAP_MMSG_MAX)
+		vlen = NETWRAP_MMSG_MAX;
+
+	for (i = 0; i < vlen; i++) {
+		msg = &msgvec[i].msg_hdr;
+		nfp_msg = &nfp_msgvec[i].msg_hdr;
+
+		if (msg->msg_iovlen > (size_t)(IOV_MAX - iov_cnt)) {
+			if (i)
+				break;
+			errno = EMSGSIZE;
+			return -1;
+		}
+
+		memset(nfp_msg, 0, sizeof(*nfp_msg));
+		nfp_msg->msg_iov = &nfp_iov[iov_cnt];
+		nfp_msg->msg_iovlen = (int)msg->msg_iovlen;
+		for (j = 0; j < nfp_msg->msg_iovlen; j++) {
+			nfp_iov[iov_cnt].iov_base = msg->msg_iov[j].iov_base;
+			nfp_iov[iov_cnt].iov_len =
+				(nfp_size_t)msg->msg_iov[j].iov_len;
+			iov_cnt++;
+		}
+
+		if (!msg->msg_name)
+			continue;
+
+		nfp_msg->msg_name = &nfp_addr[i];
+		nfp_msg->msg_namelen = sizeof(nfp_addr[i]);
+		memset(&nfp_addr[i], 0, sizeof(nfp_addr[i]));
+
+		if (!is_send)
+			continue;
+
+		addr = (const struct sockaddr_in *)msg->msg_name;
+		if (msg->msg_namelen < sizeof(struct sockaddr_in) ||
+		    addr->sin_family != AF_INET) {
+			if (i)
+				break;
+			errno = EINVAL;
+			return -1;
+		}
+
+		nfp_addr[i].sin_family = NFP_AF_INET;
+		nfp_addr[i].sin_addr.s_addr = addr->sin_addr.s_addr;
+		nfp_addr[i].sin_port = addr->sin_port;
+		nfp_addr[i].sin_len = sizeof(struct nfp_sockaddr_in);
+	}
+
+	return (int)i;
+}
+
+int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen,
+	     int flags, struct timespec *timeout)
+{
+	int recvmmsg_value = -1;
+
+	if (IS_NFP_SOCKET(sockfd)) {
+		struct nfp_mmsghdr nfp_msgvec[NETWRAP_MMSG_MAX];
+		struct nfp_sockaddr_in nfp_addr[NETWRAP_MMSG_MAX];
+		struct nfp_iovec nfp_iov[IOV_MAX];
+		struct nfp_timespec nfp_timeout;
+		struct sockaddr_in addr;
+		struct msghdr *msg;
+		int i, num;
+
+		num = mmsghdr_to_nfp(msgvec, vlen, nfp_msgvec, nfp_iov,
+				     nfp_addr, 0);
+		if (num <= 0)
+			return num;
+
+		if (timeout) {
+			nfp_timeout.tv_sec = (uint32_t)timeout->tv_sec;
+			nfp_timeout.tv_nsec = (uint32_t)timeout->tv_nsec;
+		}
+
+		recvmmsg_value = nfp_recvmmsg(sockfd, nfp_msgvec,
+					      (unsigned int)num,
+					      recv_flags_to_nfp(flags),
+					      timeout ? &nfp_timeout : NULL);
+		if (recvmmsg_value < 0) {
+			errno = NETWRAP_ERRNO(nfp_errno);
+			return recvmmsg_value;
+		}
+
+		for (i = 0; i < recvmmsg_value; i++) {
+			msg = &msgvec[i].msg_hdr;
+
+			msgvec[i].msg_len = nfp_msgvec[i].msg_len;
+			msg->msg_controllen = 0;
+			msg->msg_flags = 0;
+			if (nfp_msgvec[i].msg_hdr.msg_flags & NFP_MSG_TRUNC)
+				msg->msg_flags |= MSG_TRUNC;
+			if (nfp_msgvec[i].msg_hdr.msg_flags & NFP_MSG_CTRUNC)
+				msg->msg_flags |= MSG_CTRUNC;
+
+			if (!msg->msg_name)
+				continue;
+
+			memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = nfp_addr[i].sin_addr.s_addr;
+			addr.sin_port = nfp_addr[i].sin_port;
+
+			memcpy(msg->msg_name, &addr,
+			       msg->msg_namelen < sizeof(addr) ?
+			       msg->msg_namelen : sizeof(addr));
+			msg->msg_namelen = sizeof(addr);
+		}
+	} else if (libc_recvmmsg)
+		recvmmsg_value = (*libc_recvmmsg)(sockfd, msgvec, vlen, flags,
+						  timeout);
+	else {
+		LIBC_FUNCTION(recvmmsg);
+
+		if (libc_recvmmsg)
+			recvmmsg_value = (*libc_recvmmsg)(sockfd, msgvec, vlen,
+							  flags, timeout);
+		else {
+			recvmmsg_value = -1;
+			errno = EACCES;
+		}
+	}
+
+	return recvmmsg_value;
+}
+
+int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen,
+	     int flags)
+{
+	int sendmmsg_value = -1;
+
+	if (IS_NFP_SOCKET(sockfd)) {
+		struct nfp_mmsghdr nfp_msgvec[NETWRAP_MMSG_MAX];
+		struct nfp_sockaddr_in nfp_addr[NETWRAP_MMSG_MAX];
+		struct nfp_iovec nfp_iov[IOV_MAX];
+		int i, num;
+
+		num = mmsghdr_to_nfp(msgvec, vlen, nfp_msgvec, nfp_iov,
+				     nfp_addr, 1);
+		if (num <= 0)
+			return num;
+
+		sendmmsg_value = nfp_sendmmsg(sockfd, nfp_msgvec,
+					      (unsigned int)num,
+					      send_flags_to_nfp(flags));
+		if (sendmmsg_value < 0) {
+			errno = NETWRAP_ERRNO(nfp_errno);
+			return sendmmsg_value;
+		}
+
+		for (i = 0; i < sendmmsg_value; i++)
+			msgvec[i].msg_len = nfp_msgvec[i].msg_len;
+	} else if (libc_sendmmsg)
+		sendmmsg_value = (*libc_sendmmsg)(sockfd, msgvec, vlen, flags);
+	else {
+		LIBC_FUNCTION(sendmmsg);
+
+		if (libc_sendmmsg)
+			sendmmsg_value = (*libc_sendmmsg)(sockfd, msgvec, vlen,
+							  flags);
+		else {
+			sendmmsg_value = -1;
+			errno = EACCES;
+		}
+	}
+
+	return sendmmsg_value;
+}
@@ -318,7 +318,7 @@ int main(int argc, char *argv[])
 	odp_pktout_queue_param_t pktout_param;
 	odp_pktio_t pktio;
 	int sd = -1;
-	nfp_channel_t chn = NFP_CHANNEL_INVALID;
+	nfpexpl_udp_burst_t ub = {.sd = -1, .chn = NFP_CHANNEL_INVALID};
 
 	/* add handler for Ctr+C */
 	if (nfpexpl_sigaction_set(nfpexpl_sigfunction_stop)) {
@@ -497,15 +497,8 @@ int main(int argc, char *argv[])
 	}
 	sleep(1);
 
-	if (params.method == METHOD_CHANNEL) {
-		chn = udp_channel_config();
-		if (chn == NFP_CHANNEL_INVALID) {
-			NFP_ERR("Error: udp_channel_config failed.");
-			goto end;
-		}
-	}
-
-	sd = udp_socket_cfg(params.laddr, params.lport, &chn);
+	sd = udp_socket_cfg(params.laddr, params.lport,
+			    params.method == METHOD_CHANNEL ? &ub : NULL);
 	if (sd == -1) {
 		NFP_ERR("Error: udp_socket_cfg failed.");
 		nfp_stop_processing();
@@ -520,7 +513,7 @@ int main(int argc, char *argv[])
 	nfp_thread_param_init(&thread_param);
 	if (params.method == METHOD_CHANNEL) {
 		thread_param.start = termination_channel;
-		thread_param.arg = &chn;
+		thread_param.arg = &ub;
 	} else {
 		thread_param.start = termination_posix;
 		thread_param.arg = &sd;
@@ -546,8 +539,8 @@ end:
 	if (udp_socket_cleanup(sd))
 		printf("Error: udp_socket_cleanup failed.\n");
 
-	if (udp_channel_cleanup(chn))
-		printf("Error: udp_channel_cleanup failed.\n");
+	if (nfpexpl_udp_burst_term(&ub))
+		printf("Error: nfpexpl_udp_burst_term failed.\n");
 
 	if (nfp_terminate() < 0)
 		printf("Error: nfp_terminate failed.\n");
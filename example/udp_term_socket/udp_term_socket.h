@@ -7,17 +7,16 @@
 #ifndef __NFP_UDP_TERM_SOCKET_H__
 #define __NFP_UDP_TERM_SOCKET_H__
 
+#include "udp_burst.h"
+
 #define TEST_LPORT 5001
 
 extern uint64_t received_total;
 extern uint64_t received_pkt_total;
 
-int udp_socket_cfg(char *laddr, uint16_t lport, nfp_channel_t *chn);
+int udp_socket_cfg(char *laddr, uint16_t lport, nfpexpl_udp_burst_t *ub);
 int udp_socket_cleanup(int sd);
 
-nfp_channel_t udp_channel_config(void);
-int udp_channel_cleanup(nfp_channel_t chn);
-
 int termination_posix(void *arg);
 int termination_channel(void *arg);
 
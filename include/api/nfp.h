@@ -61,6 +61,7 @@ extern "C" {
 #include "nfp_print.h"
 #include "nfp_time.h"
 #include "nfp_select.h"
+#include "nfp_poll.h"
 #include "nfp_pkt_channel.h"
 #include "nfp_pkt_vector.h"
 #include "nfp_netdb.h"
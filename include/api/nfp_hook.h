@@ -9,6 +9,7 @@
 #define __NFP_HOOK_H__
 
 #include <odp_api.h>
+#include "nfp_pkt_vector.h"
 
 #if __GNUC__ >= 4
 #pragma GCC visibility push(default)
@@ -33,6 +34,30 @@
  */
 typedef enum nfp_return_code (*nfp_pkt_hook)(odp_packet_t pkt, void *arg);
 
+/**
+ * @brief Vector function callback format
+ *
+ * The callback receives all the unprocessed packets of a packet vector
+ * (entries between vec->num_processed and vec->num) and stores a verdict
+ * for each of them in vec->ret[]. The verdicts are initialized to
+ * NFP_PKT_CONTINUE before the callback is called:
+ * - NFP_PKT_CONTINUE: the packet continues the NFP processing
+ * - NFP_PKT_PROCESSED: the packet was consumed by the callback
+ * - NFP_PKT_DROP: the packet is dropped (freed by NFP)
+ *
+ * The callback must not change the packets order or vec->num.
+ *
+ * @param vec Packet vector received by the hook callback
+ * @param arg User argument
+ *
+ * @retval 0 on success
+ * @retval -1 on error (the packets with a NFP_PKT_CONTINUE verdict are
+ *         dropped)
+ *
+ * @see nfp_pkt_hook_multi_processing()
+ */
+typedef int (*nfp_pkt_hook_multi)(nfp_pkt_vector_t *vec, void *arg);
+
 /**
  * @brief Hook handles
  *
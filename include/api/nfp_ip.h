@@ -82,6 +82,23 @@ struct nfp_ip {
 
 #define NFP_IP_MAXPACKET	65535		/* maximum packet size */
 
+/**
+ * Decrement the time to live of an IPv4 header.
+ *
+ * The header checksum is updated incrementally (RFC 1624), without
+ * summing up the header again. Caller must check that ip_ttl > 1.
+ *
+ * @param ip  IPv4 header
+ */
+static inline void nfp_ip_decr_ttl(struct nfp_ip *ip)
+{
+	uint16_t old_val = odp_cpu_to_be_16((uint16_t)(ip->ip_ttl << 8));
+
+	ip->ip_ttl--;
+	ip->ip_sum = nfp_cksum_update16(ip->ip_sum, old_val,
+			odp_cpu_to_be_16((uint16_t)(ip->ip_ttl << 8)));
+}
+
 /*
  * Definitions for IP type of service (ip_tos).
  */
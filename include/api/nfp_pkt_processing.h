@@ -11,6 +11,7 @@
 #include <odp_api.h>
 #include "nfp_types.h"
 #include "nfp_pkt_vector.h"
+#include "nfp_hook.h"
 
 #if __GNUC__ >= 4
 #pragma GCC visibility push(default)
@@ -92,6 +93,89 @@ int nfp_packet_input_multi(nfp_pkt_vector_t *vec,
 			   odp_queue_t in_queue,
 			   nfp_pkt_processing_multi_func pkt_multi_func);
 
+/**
+ * Process multiple packets with a vector hook in front of a packet
+ * processing function.
+ *
+ * The vector hook classifies all the unprocessed packets of the vector
+ * with a single call (see nfp_pkt_hook_multi). The packets with a
+ * NFP_PKT_CONTINUE verdict are collected in a new vector and processed
+ * with 'pkt_multi_func'. The results are stored back in vec->ret[].
+ * The packets left unprocessed by 'pkt_multi_func' are marked as
+ * NFP_PKT_DROP.
+ *
+ * To be used from a packet processing function passed to
+ * nfp_packet_input_multi(), e.g.:
+ *
+ *   static int fw_processing_multi(nfp_pkt_vector_t *vec)
+ *   {
+ *           return nfp_pkt_hook_multi_processing(vec, fw_hook, NULL,
+ *                           nfp_eth_vlan_processing_multi);
+ *   }
+ *
+ * @param[in,out] vec       Packets to process.
+ * @param hook              Vector hook
+ * @param arg               Argument passed to the vector hook
+ * @param pkt_multi_func    Packet processing function for the packets
+ *                          accepted by the hook. This may be one of the
+ *                          nfp_*_processing_multi() functions.
+ *
+ * @return  0   Success
+ * @return -1   Error. On hook error, the packets with a NFP_PKT_CONTINUE
+ *              verdict are dropped and the other verdicts are kept.
+ */
+static inline int nfp_pkt_hook_multi_processing(nfp_pkt_vector_t *vec,
+		nfp_pkt_hook_multi hook, void *arg,
+		nfp_pkt_processing_multi_func pkt_multi_func)
+{
+	nfp_pkt_vector_t vec_next;
+	uint16_t vec_idx[NFP_PKT_VECTOR_SIZE];
+	enum nfp_return_code ret;
+	uint16_t i, j;
+	int res;
+
+	if (vec == NULL || hook == NULL || pkt_multi_func == NULL)
+		return -1;
+
+	for (i = vec->num_processed; i < vec->num; i++)
+		vec->ret[i] = NFP_PKT_CONTINUE;
+
+	if (hook(vec, arg)) {
+		/* Keep the verdicts set by the hook: the packets it consumed
+		 * must not be freed */
+		for (i = vec->num_processed; i < vec->num; i++)
+			if (vec->ret[i] == NFP_PKT_CONTINUE)
+				vec->ret[i] = NFP_PKT_DROP;
+		vec->num_processed = vec->num;
+		return -1;
+	}
+
+	nfp_pkt_vector_init(&vec_next);
+	for (i = vec->num_processed; i < vec->num; i++) {
+		if (vec->ret[i] != NFP_PKT_CONTINUE)
+			continue;
+
+		vec_idx[vec_next.num] = i;
+		nfp_pkt_vector_add(&vec_next, vec->pkt[i]);
+	}
+	vec->num_processed = vec->num;
+
+	if (!NFP_PKT_VECTOR_HAS_DATA(&vec_next))
+		return 0;
+
+	res = pkt_multi_func(&vec_next);
+
+	for (j = 0; j < vec_next.num; j++) {
+		if (nfp_pkt_vector_get_return_code(&vec_next, j, &ret))
+			ret = NFP_PKT_DROP;
+
+		vec->pkt[vec_idx[j]] = vec_next.pkt[j];
+		vec->ret[vec_idx[j]] = ret;
+	}
+
+	return res;
+}
+
 /**
  * Process a packet, starting with L2.
  *
@@ -0,0 +1,281 @@
+/* Copyright (c) 2026, Bogdan Pricope
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#ifndef __NFP_POLL_H__
+#define __NFP_POLL_H__
+
+#include <stdint.h>
+#include "nfp_config.h"
+#include "nfp_time.h"
+#include "nfp_errno.h"
+#include "nfp_init.h"
+#include "nfp_socket.h"
+#include "nfp_select.h"
+
+#if __GNUC__ >= 4
+#pragma GCC visibility push(default)
+#endif
+
+/* Requested (events) and returned (revents) events */
+#define NFP_POLLIN	0x0001		/* any readable data available */
+#define NFP_POLLPRI	0x0002		/* OOB/Urgent readable data */
+#define NFP_POLLOUT	0x0004		/* file descriptor is writeable */
+#define NFP_POLLRDNORM	0x0040		/* non-OOB/URG data available */
+#define NFP_POLLWRNORM	NFP_POLLOUT	/* no write type differentiation */
+
+/* Returned (revents) events only */
+#define NFP_POLLERR	0x0008		/* some poll error occurred */
+#define NFP_POLLHUP	0x0010		/* file descriptor was "hung up" */
+#define NFP_POLLNVAL	0x0020		/* requested events "invalid" */
+
+typedef unsigned int nfp_nfds_t;
+
+struct nfp_pollfd {
+	int	fd;		/* socket descriptor */
+	short	events;		/* events to look for */
+	short	revents;	/* events found */
+};
+
+/* Socket descriptor offset: nfp_select() monitors the descriptors in
+ * [sd_offset, sd_offset + NFP_SELECT_SET_SIZE) */
+static inline int nfp_poll_sd_offset(uint32_t *sd_offset)
+{
+	static uint32_t offset;
+	static int offset_valid;
+	nfp_param_t param;
+
+	if (!offset_valid) {
+		if (nfp_get_parameters(&param)) {
+			nfp_errno = NFP_EINVAL;
+			return -1;
+		}
+		offset = param.global_param.socket.sd_offset;
+		offset_valid = 1;
+	}
+
+	*sd_offset = offset;
+	return 0;
+}
+
+static inline int nfp_poll_sd_valid(int sd)
+{
+	int type;
+	nfp_socklen_t len = sizeof(type);
+
+	return nfp_getsockopt(sd, NFP_SOL_SOCKET, NFP_SO_TYPE, &type,
+			      &len) == 0;
+}
+
+/* Common implementation of nfp_poll() and nfp_ppoll(): NULL timeout
+ * waits without limit. */
+static inline int nfp_poll_timeval(struct nfp_pollfd *fds, nfp_nfds_t nfds,
+				   struct nfp_timeval *timeout)
+{
+	nfp_fd_set rfds, wfds, efds;
+	nfp_fd_set *prfds, *pwfds, *pefds;
+	struct nfp_timeval tv_zero = {0, 0};
+	uint32_t sd_offset;
+	int max_fd, num_nval = 0, num = 0, checked = 0, ret;
+	nfp_nfds_t i;
+
+	if (fds == NULL && nfds) {
+		nfp_errno = NFP_EFAULT;
+		return -1;
+	}
+
+	if (nfp_poll_sd_offset(&sd_offset))
+		return -1;
+
+	for (i = 0; i < nfds; i++) {
+		fds[i].revents = 0;
+
+		if (fds[i].fd < 0)
+			continue;
+
+		if ((uint32_t)fds[i].fd < sd_offset ||
+		    (uint32_t)fds[i].fd - sd_offset >= NFP_SELECT_SET_SIZE) {
+			fds[i].revents = NFP_POLLNVAL;
+			num_nval++;
+		}
+	}
+
+	while (1) {
+		prfds = NULL;
+		pwfds = NULL;
+		pefds = NULL;
+		max_fd = -1;
+
+		for (i = 0; i < nfds; i++) {
+			if (fds[i].fd < 0 || fds[i].revents)
+				continue;
+
+			if ((fds[i].events & (NFP_POLLIN | NFP_POLLRDNORM)) &&
+			    prfds == NULL) {
+				prfds = &rfds;
+				NFP_FD_ZERO(prfds);
+			}
+			if ((fds[i].events & NFP_POLLOUT) && pwfds == NULL) {
+				pwfds = &wfds;
+				NFP_FD_ZERO(pwfds);
+			}
+			if ((fds[i].events & NFP_POLLPRI) && pefds == NULL) {
+				pefds = &efds;
+				NFP_FD_ZERO(pefds);
+			}
+
+			if (fds[i].events & (NFP_POLLIN | NFP_POLLRDNORM))
+				NFP_FD_SET(fds[i].fd, prfds);
+			if (fds[i].events & NFP_POLLOUT)
+				NFP_FD_SET(fds[i].fd, pwfds);
+			if (fds[i].events & NFP_POLLPRI)
+				NFP_FD_SET(fds[i].fd, pefds);
+
+			if (fds[i].fd > max_fd)
+				max_fd = fds[i].fd;
+		}
+
+		if (max_fd < 0 ||
+		    (prfds == NULL && pwfds == NULL && pefds == NULL)) {
+			if (num_nval)
+				return num_nval;
+
+			/* Nothing to check: wait out the timeout, as poll() */
+			if (nfp_select(0, NULL, NULL, NULL, timeout) < 0)
+				return -1;
+			return 0;
+		}
+
+		/* Do not wait when invalid descriptors are already reported */
+		if (num_nval)
+			timeout = &tv_zero;
+
+		ret = nfp_select(max_fd + 1, prfds, pwfds, pefds, timeout);
+		if (ret >= 0)
+			break;
+
+		if (nfp_errno != NFP_EBADF || checked)
+			return -1;
+
+		/* Report the closed descriptors per entry and select again */
+		checked = 1;
+		for (i = 0; i < nfds; i++) {
+			if (fds[i].fd < 0 || fds[i].revents ||
+			    nfp_poll_sd_valid(fds[i].fd))
+				continue;
+
+			fds[i].revents = NFP_POLLNVAL;
+			num_nval++;
+		}
+
+		if (num_nval == 0) {
+			nfp_errno = NFP_EBADF;
+			return -1;
+		}
+	}
+
+	if (ret == 0)
+		return num_nval;
+
+	for (i = 0; i < nfds; i++) {
+		if (fds[i].fd < 0 || fds[i].revents == NFP_POLLNVAL)
+			continue;
+
+		if (prfds && NFP_FD_ISSET(fds[i].fd, prfds))
+			fds[i].revents |= fds[i].events &
+				(NFP_POLLIN | NFP_POLLRDNORM);
+		if (pwfds && NFP_FD_ISSET(fds[i].fd, pwfds))
+			fds[i].revents |= NFP_POLLOUT;
+		if (pefds && NFP_FD_ISSET(fds[i].fd, pefds))
+			fds[i].revents |= NFP_POLLPRI;
+
+		if (fds[i].revents)
+			num++;
+	}
+
+	return num + num_nval;
+}
+
+/**
+ * Wait for events on a set of sockets.
+ *
+ * poll() like interface built on nfp_select(): the requested events are
+ * converted into nfp_fd_set descriptor sets (up to three, zeroed on each
+ * call) and checked with a single nfp_select() call. Differences from
+ * poll():
+ *  - NFP_POLLERR and NFP_POLLHUP are never reported. As with nfp_select(),
+ *    a socket error or the end of the stream are reported as readable
+ *    (NFP_POLLIN) and returned by the next receive call. Entries without
+ *    requested events are not reported.
+ *  - Descriptors outside the nfp_select() range ([sd_offset, sd_offset +
+ *    NFP_SELECT_SET_SIZE)) are reported as NFP_POLLNVAL. Closed
+ *    descriptors are also reported per entry as NFP_POLLNVAL: when
+ *    nfp_select() fails with NFP_EBADF, each descriptor is checked and
+ *    nfp_select() is called again without the invalid ones.
+ *  - Entries with a negative descriptor are ignored, as with poll(). When
+ *    no event can be checked (nfds 0, negative descriptors or no requested
+ *    events), the call waits for the timeout with nfp_select(), as poll()
+ *    does.
+ *
+ * @param fds      Array of sockets and requested events
+ * @param nfds     Number of entries in fds[]
+ * @param timeout  Timeout in milliseconds. A negative value waits
+ *                 without limit; 0 returns immediately.
+ *
+ * @return Number of entries with non-zero revents, 0 on timeout,
+ *         -1 on error (nfp_errno is set)
+ */
+static inline int nfp_poll(struct nfp_pollfd *fds, nfp_nfds_t nfds,
+			   int timeout)
+{
+	struct nfp_timeval tv;
+
+	if (timeout < 0)
+		return nfp_poll_timeval(fds, nfds, NULL);
+
+	tv.tv_sec = (uint32_t)timeout / 1000;
+	tv.tv_usec = ((uint32_t)timeout % 1000) * 1000;
+
+	return nfp_poll_timeval(fds, nfds, &tv);
+}
+
+/**
+ * Wait for events on a set of sockets, with a nanosecond resolution
+ * timeout.
+ *
+ * Same as nfp_poll(). NFP sockets do not deliver signals, so there is no
+ * signal mask argument.
+ *
+ * @param fds      Array of sockets and requested events
+ * @param nfds     Number of entries in fds[]
+ * @param timeout  Timeout, or NULL to wait without limit. The timeout is
+ *                 rounded up to the nfp_select() resolution (microsecond).
+ *
+ * @return Number of entries with non-zero revents, 0 on timeout,
+ *         -1 on error (nfp_errno is set)
+ */
+static inline int nfp_ppoll(struct nfp_pollfd *fds, nfp_nfds_t nfds,
+			    const struct nfp_timespec *timeout)
+{
+	struct nfp_timeval tv;
+
+	if (timeout == NULL)
+		return nfp_poll_timeval(fds, nfds, NULL);
+
+	tv.tv_sec = timeout->tv_sec + timeout->tv_nsec / 1000000000;
+	tv.tv_usec = ((timeout->tv_nsec % 1000000000) + 999) / 1000;
+	if (tv.tv_usec >= 1000000) {
+		tv.tv_sec++;
+		tv.tv_usec -= 1000000;
+	}
+
+	return nfp_poll_timeval(fds, nfds, &tv);
+}
+
+#if __GNUC__ >= 4
+#pragma GCC visibility pop
+#endif
+
+#endif /* __NFP_POLL_H__ */
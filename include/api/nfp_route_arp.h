@@ -159,6 +159,87 @@ struct nfp_nh_entry *nfp_get_next_hop(uint16_t vrf,
 struct nfp_nh6_entry *nfp_get_next_hop6(uint16_t vrf,
 		uint8_t *addr, uint32_t *flags);
 
+/**
+ * Get the next hops of multiple IPv4 destinations
+ *
+ * Looks up the next hop of each (vrf[i], addr[i]) pair. Consecutive
+ * lookups of the same destination (e.g. packets of the same flow in a
+ * packet vector) are resolved once.
+ *
+ * @param vrf	Array of VRFs
+ * @param addr	Array of destination addresses
+ * @param flags	Array where the route flags are returned (may be NULL)
+ * @param nh	Array where the next hops are returned. An entry is set to
+ *		NULL if there is no route to the destination.
+ * @param num	Number of destinations
+ *
+ * @retval	Number of destinations with a route
+ */
+static inline int nfp_get_next_hop_multi(const uint16_t vrf[],
+					 const uint32_t addr[],
+					 uint32_t flags[],
+					 struct nfp_nh_entry *nh[], int num)
+{
+	uint32_t flags_local = 0;
+	int i, found = 0;
+
+	for (i = 0; i < num; i++) {
+		if (i > 0 && vrf[i] == vrf[i - 1] && addr[i] == addr[i - 1]) {
+			nh[i] = nh[i - 1];
+		} else {
+			flags_local = 0;
+			nh[i] = nfp_get_next_hop(vrf[i], addr[i], &flags_local);
+		}
+		if (flags)
+			flags[i] = flags_local;
+		if (nh[i])
+			found++;
+	}
+
+	return found;
+}
+
+/**
+ * Get the next hops of multiple IPv6 destinations
+ *
+ * Looks up the next hop of each (vrf[i], addr[i]) pair. Consecutive
+ * lookups of the same destination (e.g. packets of the same flow in a
+ * packet vector) are resolved once.
+ *
+ * @param vrf	Array of VRFs
+ * @param addr	Array of pointers to destination addresses (16 bytes)
+ * @param flags	Array where the route flags are returned (may be NULL)
+ * @param nh	Array where the next hops are returned. An entry is set to
+ *		NULL if there is no route to the destination.
+ * @param num	Number of destinations
+ *
+ * @retval	Number of destinations with a route
+ */
+static inline int nfp_get_next_hop6_multi(const uint16_t vrf[],
+					  uint8_t *addr[],
+					  uint32_t flags[],
+					  struct nfp_nh6_entry *nh[], int num)
+{
+	uint32_t flags_local = 0;
+	int i, found = 0;
+
+	for (i = 0; i < num; i++) {
+		if (i > 0 && vrf[i] == vrf[i - 1] &&
+		    memcmp(addr[i], addr[i - 1], 16) == 0) {
+			nh[i] = nh[i - 1];
+		} else {
+			flags_local = 0;
+			nh[i] = nfp_get_next_hop6(vrf[i], addr[i], &flags_local);
+		}
+		if (flags)
+			flags[i] = flags_local;
+		if (nh[i])
+			found++;
+	}
+
+	return found;
+}
+
 /* ROUTE default */
 /**
  * Set or delete an IPv4 default route
@@ -201,6 +282,53 @@ int nfp_get_mac(struct nfp_ifnet *dev, struct nfp_nh_entry *nh_data,
 		uint32_t addr, uint32_t is_link_local, uint8_t *mac_out);
 void nfp_add_mac6(struct nfp_ifnet *dev, uint8_t *addr, uint8_t *mac);
 
+/**
+ * Get the MAC addresses of multiple IPv4 next hops
+ *
+ * Resolves the MAC address of each (dev[i], addr[i]) next hop with
+ * nfp_get_mac(). Each distinct next hop of the batch is resolved only
+ * once and the result is copied to all the entries using it.
+ *
+ * @param dev		Array of output interfaces
+ * @param nh_data	Array of next hop entries
+ * @param addr		Array of next hop addresses
+ * @param is_link_local	Link local flag passed to nfp_get_mac()
+ * @param mac_out	Array of buffers (6 bytes) where the MAC addresses
+ *			are returned
+ * @param res		Array where the nfp_get_mac() result of each entry
+ *			is returned (0 when resolved)
+ * @param num		Number of next hops
+ *
+ * @retval		Number of resolved next hops
+ */
+static inline int nfp_get_mac_multi(struct nfp_ifnet *dev[],
+				    struct nfp_nh_entry *nh_data[],
+				    const uint32_t addr[],
+				    uint32_t is_link_local,
+				    uint8_t *mac_out[], int res[], int num)
+{
+	int i, j, found = 0;
+
+	for (i = 0; i < num; i++) {
+		for (j = 0; j < i; j++)
+			if (addr[j] == addr[i] && dev[j] == dev[i])
+				break;
+
+		if (j < i) {
+			res[i] = res[j];
+			if (res[i] == 0)
+				memcpy(mac_out[i], mac_out[j], 6);
+		} else
+			res[i] = nfp_get_mac(dev[i], nh_data[i], addr[i],
+					     is_link_local, mac_out[i]);
+
+		if (res[i] == 0)
+			found++;
+	}
+
+	return found;
+}
+
 #if __GNUC__ >= 4
 #pragma GCC visibility pop
 #endif
@@ -38,6 +38,8 @@
 #include <odp_api.h>
 #include "nfp_socket_types.h"
 #include "nfp_config.h"
+#include "nfp_errno.h"
+#include "nfp_time.h"
 
 #if __GNUC__ >= 4
 #pragma GCC visibility push(default)
@@ -237,6 +239,15 @@ struct nfp_msghdr {
 #define	NFP_MSG_SOCALLBCK	0x10000		/* for use by socket callbacks - nfp_soreceive (TCP) */
 #define	NFP_MSG_NOSIGNAL	0x20000		/* do not generate SIGPIPE on EOF */
 #define	NFP_MSG_HOLE_BREAK	0x40000		/* stop at and indicate hole boundary */
+#define	NFP_MSG_WAITFORONE	0x80000		/* for nfp_recvmmsg() */
+
+/*
+ * Message header for nfp_recvmmsg() and nfp_sendmmsg().
+ */
+struct nfp_mmsghdr {
+	struct nfp_msghdr	msg_hdr;	/* message header */
+	unsigned int		msg_len;	/* bytes transmitted */
+};
 
 /*
  * Header for ancillary data objects in msg_control buffer.
@@ -416,6 +427,155 @@ int	nfp_getpeername(int, struct nfp_sockaddr *, nfp_socklen_t *);
 
 int	nfp_ioctl(int, int, ...);
 
+/**
+ * Receive multiple messages from a socket.
+ *
+ * Same semantics as Linux recvmmsg(): messages are received with
+ * nfp_recvmsg() into msgvec[] until 'vlen' messages are received, an
+ * error occurs or the timeout expires. The number of bytes received in each
+ * message is stored in msg_len.
+ *
+ * @param sd       Socket descriptor
+ * @param msgvec   Array of message headers
+ * @param vlen     Number of message headers in msgvec[]
+ * @param flags    nfp_recvmsg() flags. With NFP_MSG_WAITFORONE,
+ *                 NFP_MSG_DONTWAIT is set after the first message.
+ * @param timeout  Timeout checked after each received message, or NULL
+ *
+ * @return Number of messages received, -1 on error (nfp_errno is set).
+ *         An error after the first message is not reported.
+ */
+static inline int nfp_recvmmsg(int sd, struct nfp_mmsghdr *msgvec,
+			       unsigned int vlen, int flags,
+			       struct nfp_timespec *timeout)
+{
+	odp_time_t start = odp_time_local();
+	uint64_t tmo_ns = 0;
+	nfp_ssize_t len;
+	unsigned int i;
+
+	if (msgvec == NULL) {
+		nfp_errno = NFP_EFAULT;
+		return -1;
+	}
+
+	if (timeout)
+		tmo_ns = (uint64_t)timeout->tv_sec * ODP_TIME_SEC_IN_NS +
+			timeout->tv_nsec;
+
+	for (i = 0; i < vlen; i++) {
+		len = nfp_recvmsg(sd, &msgvec[i].msg_hdr,
+				  flags & ~NFP_MSG_WAITFORONE);
+		if (len < 0)
+			return i ? (int)i : -1;
+
+		msgvec[i].msg_len = (unsigned int)len;
+
+		if (flags & NFP_MSG_WAITFORONE)
+			flags |= NFP_MSG_DONTWAIT;
+
+		if (timeout &&
+		    odp_time_diff_ns(odp_time_local(), start) >= tmo_ns)
+			return (int)(i + 1);
+	}
+
+	return (int)i;
+}
+
+/**
+ * Send multiple messages on a socket.
+ *
+ * Same semantics as Linux sendmmsg(): messages of msgvec[] are sent with
+ * nfp_sendmsg() until 'vlen' messages are sent or an error occurs. The
+ * number of bytes sent from each message is stored in msg_len.
+ *
+ * @param sd       Socket descriptor
+ * @param msgvec   Array of message headers
+ * @param vlen     Number of message headers in msgvec[]
+ * @param flags    nfp_sendmsg() flags
+ *
+ * @return Number of messages sent, -1 on error (nfp_errno is set).
+ *         An error after the first message is not reported.
+ */
+static inline int nfp_sendmmsg(int sd, struct nfp_mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	nfp_ssize_t len;
+	unsigned int i;
+
+	if (msgvec == NULL) {
+		nfp_errno = NFP_EFAULT;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		len = nfp_sendmsg(sd, &msgvec[i].msg_hdr, flags);
+		if (len < 0)
+			return i ? (int)i : -1;
+
+		msgvec[i].msg_len = (unsigned int)len;
+	}
+
+	return (int)i;
+}
+
+/**
+ * Write data from multiple buffers to a socket.
+ *
+ * Same semantics as writev(): the buffers are sent with a single
+ * nfp_sendmsg() call, so that TCP segments are built across the buffer
+ * boundaries.
+ *
+ * @param sd      Socket descriptor
+ * @param iov     Array of buffers
+ * @param iovcnt  Number of buffers in iov[]
+ *
+ * @return Number of bytes sent, -1 on error (nfp_errno is set)
+ */
+static inline nfp_ssize_t nfp_writev(int sd, const struct nfp_iovec *iov,
+				     int iovcnt)
+{
+	struct nfp_msghdr msg;
+
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+	msg.msg_iov = (struct nfp_iovec *)(uintptr_t)iov;
+	msg.msg_iovlen = iovcnt;
+	msg.msg_control = NULL;
+	msg.msg_controllen = 0;
+	msg.msg_flags = 0;
+
+	return nfp_sendmsg(sd, &msg, 0);
+}
+
+/**
+ * Read data from a socket into multiple buffers.
+ *
+ * Same semantics as readv(): the buffers are filled with a single
+ * nfp_recvmsg() call.
+ *
+ * @param sd      Socket descriptor
+ * @param iov     Array of buffers
+ * @param iovcnt  Number of buffers in iov[]
+ *
+ * @return Number of bytes received, -1 on error (nfp_errno is set)
+ */
+static inline nfp_ssize_t nfp_readv(int sd, const struct nfp_iovec *iov,
+				    int iovcnt)
+{
+	struct nfp_msghdr msg;
+
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+	msg.msg_iov = (struct nfp_iovec *)(uintptr_t)iov;
+	msg.msg_iovlen = iovcnt;
+	msg.msg_control = NULL;
+	msg.msg_controllen = 0;
+	msg.msg_flags = 0;
+
+	return nfp_recvmsg(sd, &msg, 0);
+}
+
 void	*nfp_udp_packet_parse(odp_packet_t, int *,
 				struct nfp_sockaddr *,
 				nfp_socklen_t *);